@@ -0,0 +1,644 @@
+#include "BlockEncoder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+static constexpr uint32_t texelsPerBlock = blockDimension * blockDimension;
+static constexpr int refinementPasses = 2;
+static constexpr uint8_t bc7Weights[16]
+    = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+static constexpr uint8_t astcRgbWeights[8] = { 0, 9, 18, 27, 37, 46, 55, 64 };
+static constexpr uint8_t astcRgbaWeights[4] = { 0, 21, 43, 64 };
+// ASTC block modes for a 4x4 single-plane weight grid with QUANT_8 and QUANT_4 weights. With one
+// partition these leave room for 8-bit endpoints, so no trit/quint packing is needed.
+static constexpr uint32_t astcRgbBlockMode = 0x53;
+static constexpr uint32_t astcRgbaBlockMode = 0x42;
+static constexpr uint32_t astcCemRgb = 8;
+static constexpr uint32_t astcCemRgba = 12;
+
+namespace {
+class BitWriter {
+private:
+    uint8_t* data;
+    uint32_t pos;
+
+public:
+    BitWriter(uint8_t* block)
+        : data(block)
+        , pos(0)
+    {
+    }
+    void write(uint32_t value, uint32_t bits)
+    {
+        for (uint32_t i = 0; i < bits; i++, this->pos++) {
+            if ((value >> i) & 1)
+                this->data[this->pos >> 3] |= 1 << (this->pos & 7);
+        }
+    }
+};
+
+class BitReader {
+private:
+    const uint8_t* data;
+    uint32_t pos;
+
+public:
+    BitReader(const uint8_t* block)
+        : data(block)
+        , pos(0)
+    {
+    }
+    uint32_t read(uint32_t bits)
+    {
+        uint32_t value = 0;
+        for (uint32_t i = 0; i < bits; i++, this->pos++)
+            value |= ((this->data[this->pos >> 3] >> (this->pos & 7)) & 1u) << i;
+        return value;
+    }
+};
+}
+
+static uint8_t roundToUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 255.0f) + 0.5f);
+}
+
+// Endpoints along the principal axis of the block's color distribution.
+static void fitPrincipalAxis(const uint8_t* texels, uint32_t channels, float* lo, float* hi)
+{
+    float mean[4] = {};
+    float covariance[4][4] = {};
+    float axis[4] = {};
+    float minProjection = 0.0f;
+    float maxProjection = 0.0f;
+
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        for (uint32_t c = 0; c < channels; c++)
+            mean[c] += texels[i * 4 + c] / static_cast<float>(texelsPerBlock);
+    }
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        for (uint32_t a = 0; a < channels; a++) {
+            for (uint32_t b = 0; b < channels; b++)
+                covariance[a][b] += (texels[i * 4 + a] - mean[a]) * (texels[i * 4 + b] - mean[b]);
+        }
+    }
+    // Start from the covariance column of the widest channel; unlike the bounding box diagonal it
+    // is never orthogonal to the principal axis when channels are anti-correlated.
+    uint32_t widest = 0;
+    for (uint32_t c = 1; c < channels; c++) {
+        if (covariance[c][c] > covariance[widest][widest])
+            widest = c;
+    }
+    for (uint32_t c = 0; c < channels; c++)
+        axis[c] = covariance[c][widest];
+
+    for (int iteration = 0; iteration < 8; iteration++) {
+        float next[4] = {};
+        float largest = 0.0f;
+        for (uint32_t a = 0; a < channels; a++) {
+            for (uint32_t b = 0; b < channels; b++)
+                next[a] += covariance[a][b] * axis[b];
+            largest = std::max(largest, std::fabs(next[a]));
+        }
+        if (largest < 1e-6f)
+            break;
+        for (uint32_t c = 0; c < channels; c++)
+            axis[c] = next[c] / largest;
+    }
+
+    float length = 0.0f;
+    for (uint32_t c = 0; c < channels; c++)
+        length += axis[c] * axis[c];
+    length = std::sqrt(length);
+    if (length > 1e-6f) {
+        for (uint32_t c = 0; c < channels; c++)
+            axis[c] /= length;
+        for (uint32_t i = 0; i < texelsPerBlock; i++) {
+            float projection = 0.0f;
+            for (uint32_t c = 0; c < channels; c++)
+                projection += (texels[i * 4 + c] - mean[c]) * axis[c];
+            minProjection = std::min(minProjection, projection);
+            maxProjection = std::max(maxProjection, projection);
+        }
+    }
+    for (uint32_t c = 0; c < 4; c++) {
+        lo[c] = c < channels ? std::clamp(mean[c] + axis[c] * minProjection, 0.0f, 255.0f) : 255.0f;
+        hi[c] = c < channels ? std::clamp(mean[c] + axis[c] * maxProjection, 0.0f, 255.0f) : 255.0f;
+    }
+}
+
+// Least-squares endpoints for the interpolation weights chosen in the previous pass.
+static bool refineEndpoints(
+    const uint8_t* texels, uint32_t channels, const float* weights, float* lo, float* hi)
+{
+    float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+    float ax[4] = {}, bx[4] = {};
+
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        float t = weights[i];
+        float s = 1.0f - t;
+        aa += s * s;
+        ab += s * t;
+        bb += t * t;
+        for (uint32_t c = 0; c < channels; c++) {
+            ax[c] += s * texels[i * 4 + c];
+            bx[c] += t * texels[i * 4 + c];
+        }
+    }
+
+    float determinant = aa * bb - ab * ab;
+    if (std::fabs(determinant) < 1e-6f)
+        return false;
+    for (uint32_t c = 0; c < channels; c++) {
+        lo[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+        hi[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+static uint32_t selectIndices(const uint8_t* texels, uint32_t channels,
+    const uint8_t (*palette)[4], uint32_t paletteSize, uint8_t* indices)
+{
+    uint32_t totalError = 0;
+
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        uint32_t bestError = UINT32_MAX;
+        for (uint32_t p = 0; p < paletteSize; p++) {
+            uint32_t error = 0;
+            for (uint32_t c = 0; c < channels; c++) {
+                int delta = static_cast<int>(texels[i * 4 + c]) - palette[p][c];
+                error += delta * delta;
+            }
+            if (error < bestError) {
+                bestError = error;
+                indices[i] = p;
+            }
+        }
+        totalError += bestError;
+    }
+    return totalError;
+}
+
+// encode(lo, hi, block, weights) writes a block for the given endpoints, stores each texel's
+// position between lo and hi in weights and returns the squared error.
+template <typename EncodeFn>
+static void encodeWithRefinement(const uint8_t* texels, uint32_t channels, uint32_t blockBytes,
+    uint8_t* block, EncodeFn encode)
+{
+    float lo[4], hi[4];
+    float weights[texelsPerBlock], candidateWeights[texelsPerBlock];
+    uint8_t candidate[16];
+
+    fitPrincipalAxis(texels, channels, lo, hi);
+    uint32_t error = encode(lo, hi, block, weights);
+    for (int pass = 0; pass < refinementPasses && error; pass++) {
+        if (!refineEndpoints(texels, channels, weights, lo, hi))
+            break;
+        memset(candidate, 0, sizeof(candidate));
+        uint32_t candidateError = encode(lo, hi, candidate, candidateWeights);
+        if (candidateError >= error)
+            break;
+        error = candidateError;
+        memcpy(block, candidate, blockBytes);
+        memcpy(weights, candidateWeights, sizeof(weights));
+    }
+}
+
+static uint16_t packRgb565(const float* color)
+{
+    uint32_t r = static_cast<uint32_t>(std::clamp(color[0], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    uint32_t g = static_cast<uint32_t>(std::clamp(color[1], 0.0f, 255.0f) * 63.0f / 255.0f + 0.5f);
+    uint32_t b = static_cast<uint32_t>(std::clamp(color[2], 0.0f, 255.0f) * 31.0f / 255.0f + 0.5f);
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+static void unpackRgb565(uint16_t packed, uint8_t* color)
+{
+    uint32_t r = (packed >> 11) & 0x1F;
+    uint32_t g = (packed >> 5) & 0x3F;
+    uint32_t b = packed & 0x1F;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+    color[3] = 255;
+}
+
+static void buildBc1Palette(uint16_t c0, uint16_t c1, uint8_t (*palette)[4])
+{
+    unpackRgb565(c0, palette[0]);
+    unpackRgb565(c1, palette[1]);
+    for (uint32_t c = 0; c < 3; c++) {
+        if (c0 > c1) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        } else {
+            palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+            palette[3][c] = 0;
+        }
+    }
+    palette[2][3] = 255;
+    palette[3][3] = c0 > c1 ? 255 : 0;
+}
+
+static uint32_t encodeBc1Endpoints(
+    const uint8_t* texels, const float* lo, const float* hi, uint8_t* block, float* weights)
+{
+    static constexpr float paletteWeights[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+    uint16_t c0 = packRgb565(hi);
+    uint16_t c1 = packRgb565(lo);
+    bool swapped = c0 < c1;
+    uint8_t palette[4][4];
+    uint8_t indices[texelsPerBlock] = {};
+    uint32_t error;
+
+    if (swapped)
+        std::swap(c0, c1);
+    buildBc1Palette(c0, c1, palette);
+    // Equal endpoints select the 3-color mode; index 0 is still the endpoint color there.
+    error = selectIndices(texels, 3, palette, c0 == c1 ? 1 : 4, indices);
+
+    BitWriter writer(block);
+    writer.write(c0, 16);
+    writer.write(c1, 16);
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        writer.write(indices[i], 2);
+        weights[i] = swapped ? paletteWeights[indices[i]] : 1.0f - paletteWeights[indices[i]];
+    }
+    return error;
+}
+
+static void buildBc4Palette(uint8_t r0, uint8_t r1, uint8_t* palette)
+{
+    palette[0] = r0;
+    palette[1] = r1;
+    if (r0 > r1) {
+        for (uint32_t i = 2; i < 8; i++)
+            palette[i] = ((8 - i) * r0 + (i - 1) * r1 + 3) / 7;
+    } else {
+        for (uint32_t i = 2; i < 6; i++)
+            palette[i] = ((6 - i) * r0 + (i - 1) * r1 + 2) / 5;
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+}
+
+static uint32_t encodeBc4Endpoints(
+    const uint8_t* texels, uint32_t channel, uint8_t r0, uint8_t r1, uint8_t* block)
+{
+    uint8_t palette[8];
+    uint64_t indices = 0;
+    uint32_t totalError = 0;
+
+    buildBc4Palette(r0, r1, palette);
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        uint64_t bestIndex = 0;
+        int bestError = 256;
+        for (uint32_t p = 0; p < 8; p++) {
+            int error = std::abs(static_cast<int>(texels[i * 4 + channel]) - palette[p]);
+            if (error < bestError) {
+                bestError = error;
+                bestIndex = p;
+            }
+        }
+        indices |= bestIndex << (3 * i);
+        totalError += bestError * bestError;
+    }
+    block[0] = r0;
+    block[1] = r1;
+    for (uint32_t i = 0; i < 6; i++)
+        block[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+    return totalError;
+}
+
+// Tries the 8-value mode over the full range and the 6-value mode, which has exact 0 and 255 and
+// only needs to span the texels in between.
+static void encodeBc4(const uint8_t* texels, uint32_t channel, uint8_t* block)
+{
+    uint8_t minValue = 255, maxValue = 0;
+    uint8_t innerMin = 255, innerMax = 0;
+    uint8_t candidate[8];
+
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        uint8_t value = texels[i * 4 + channel];
+        minValue = std::min(minValue, value);
+        maxValue = std::max(maxValue, value);
+        if (value != 0 && value != 255) {
+            innerMin = std::min(innerMin, value);
+            innerMax = std::max(innerMax, value);
+        }
+    }
+    if (innerMin > innerMax)
+        innerMin = innerMax = 0;
+
+    uint32_t error = encodeBc4Endpoints(texels, channel, maxValue, minValue, block);
+    if (error && encodeBc4Endpoints(texels, channel, innerMin, innerMax, candidate) < error)
+        memcpy(block, candidate, sizeof(candidate));
+}
+
+static void decodeBc4(const uint8_t* block, uint32_t channel, uint8_t* texels)
+{
+    uint8_t palette[8];
+    uint64_t indices = 0;
+
+    buildBc4Palette(block[0], block[1], palette);
+    for (uint32_t i = 0; i < 6; i++)
+        indices |= static_cast<uint64_t>(block[2 + i]) << (8 * i);
+    for (uint32_t i = 0; i < texelsPerBlock; i++)
+        texels[i * 4 + channel] = palette[(indices >> (3 * i)) & 7];
+}
+
+static void quantizeBc7Endpoint(const float* color, uint8_t* endpoint, uint32_t& pbit)
+{
+    float bestError = INFINITY;
+
+    for (uint32_t p = 0; p < 2; p++) {
+        uint8_t candidate[4];
+        float error = 0.0f;
+        for (uint32_t c = 0; c < 4; c++) {
+            float q = std::clamp(std::round((color[c] - p) / 2.0f), 0.0f, 127.0f);
+            candidate[c] = (static_cast<uint8_t>(q) << 1) | p;
+            error += (candidate[c] - color[c]) * (candidate[c] - color[c]);
+        }
+        if (error < bestError) {
+            bestError = error;
+            pbit = p;
+            memcpy(endpoint, candidate, 4);
+        }
+    }
+}
+
+static uint32_t encodeBc7Endpoints(
+    const uint8_t* texels, const float* lo, const float* hi, uint8_t* block, float* weights)
+{
+    uint8_t endpoints[2][4];
+    uint32_t pbits[2];
+    uint8_t palette[16][4];
+    uint8_t indices[texelsPerBlock];
+    uint32_t error;
+
+    quantizeBc7Endpoint(lo, endpoints[0], pbits[0]);
+    quantizeBc7Endpoint(hi, endpoints[1], pbits[1]);
+    for (uint32_t p = 0; p < 16; p++) {
+        for (uint32_t c = 0; c < 4; c++)
+            palette[p][c] = ((64 - bc7Weights[p]) * endpoints[0][c]
+                                + bc7Weights[p] * endpoints[1][c] + 32)
+                >> 6;
+    }
+    error = selectIndices(texels, 4, palette, 16, indices);
+    for (uint32_t i = 0; i < texelsPerBlock; i++)
+        weights[i] = bc7Weights[indices[i]] / 64.0f;
+
+    // The anchor index is stored without its top bit, so it has to point at the first half.
+    if (indices[0] >= 8) {
+        std::swap(endpoints[0], endpoints[1]);
+        std::swap(pbits[0], pbits[1]);
+        for (uint32_t i = 0; i < texelsPerBlock; i++)
+            indices[i] = 15 - indices[i];
+    }
+
+    BitWriter writer(block);
+    writer.write(1 << 6, 7);
+    for (uint32_t c = 0; c < 4; c++) {
+        writer.write(endpoints[0][c] >> 1, 7);
+        writer.write(endpoints[1][c] >> 1, 7);
+    }
+    writer.write(pbits[0], 1);
+    writer.write(pbits[1], 1);
+    for (uint32_t i = 0; i < texelsPerBlock; i++)
+        writer.write(indices[i], i ? 4 : 3);
+    return error;
+}
+
+static void decodeBc7(const uint8_t* block, uint8_t* texels)
+{
+    uint8_t endpoints[2][4];
+    BitReader reader(block);
+
+    if (reader.read(7) != 1 << 6)
+        throw std::runtime_error("Only BC7 mode 6 blocks can be decoded");
+    for (uint32_t c = 0; c < 4; c++) {
+        endpoints[0][c] = reader.read(7) << 1;
+        endpoints[1][c] = reader.read(7) << 1;
+    }
+    uint32_t p0 = reader.read(1);
+    uint32_t p1 = reader.read(1);
+    for (uint32_t c = 0; c < 4; c++) {
+        endpoints[0][c] |= p0;
+        endpoints[1][c] |= p1;
+    }
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        uint32_t weight = bc7Weights[reader.read(i ? 4 : 3)];
+        for (uint32_t c = 0; c < 4; c++)
+            texels[i * 4 + c]
+                = ((64 - weight) * endpoints[0][c] + weight * endpoints[1][c] + 32) >> 6;
+    }
+}
+
+// sRGB decoding expands the 8-bit endpoints to 16 bits with 0x80 instead of replicating them.
+static uint8_t astcInterpolate(uint32_t e0, uint32_t e1, uint32_t weight, bool isSrgb)
+{
+    uint32_t c0 = (e0 << 8) | (isSrgb ? 0x80 : e0);
+    uint32_t c1 = (e1 << 8) | (isSrgb ? 0x80 : e1);
+    return static_cast<uint8_t>(((c0 * (64 - weight) + c1 * weight + 32) >> 6) >> 8);
+}
+
+static uint32_t encodeAstcEndpoints(const uint8_t* texels, uint32_t channels, bool isSrgb,
+    const float* lo, const float* hi, uint8_t* block, float* weights)
+{
+    const uint8_t* weightTable = channels == 4 ? astcRgbaWeights : astcRgbWeights;
+    uint32_t weightLevels = channels == 4 ? 4 : 8;
+    uint32_t weightBits = channels == 4 ? 2 : 3;
+    uint8_t endpoints[2][4];
+    uint8_t palette[8][4];
+    uint8_t indices[texelsPerBlock];
+    uint32_t error;
+
+    for (uint32_t c = 0; c < 4; c++) {
+        endpoints[0][c] = roundToUnorm8(lo[c]);
+        endpoints[1][c] = roundToUnorm8(hi[c]);
+    }
+    for (uint32_t p = 0; p < weightLevels; p++) {
+        for (uint32_t c = 0; c < 4; c++)
+            palette[p][c]
+                = astcInterpolate(endpoints[0][c], endpoints[1][c], weightTable[p], isSrgb);
+    }
+    error = selectIndices(texels, channels, palette, weightLevels, indices);
+    for (uint32_t i = 0; i < texelsPerBlock; i++)
+        weights[i] = weightTable[indices[i]] / 64.0f;
+
+    // Decoders apply blue contraction when the second endpoint is darker, keep them ordered.
+    if (endpoints[1][0] + endpoints[1][1] + endpoints[1][2]
+        < endpoints[0][0] + endpoints[0][1] + endpoints[0][2]) {
+        std::swap(endpoints[0], endpoints[1]);
+        for (uint32_t i = 0; i < texelsPerBlock; i++)
+            indices[i] = weightLevels - 1 - indices[i];
+    }
+
+    BitWriter writer(block);
+    writer.write(channels == 4 ? astcRgbaBlockMode : astcRgbBlockMode, 11);
+    writer.write(0, 2);
+    writer.write(channels == 4 ? astcCemRgba : astcCemRgb, 4);
+    for (uint32_t c = 0; c < channels; c++) {
+        writer.write(endpoints[0][c], 8);
+        writer.write(endpoints[1][c], 8);
+    }
+    // Weights are stored bit-reversed from the top of the block.
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        for (uint32_t bit = 0; bit < weightBits; bit++) {
+            uint32_t pos = 127 - (i * weightBits + bit);
+            if ((indices[i] >> bit) & 1)
+                block[pos >> 3] |= 1 << (pos & 7);
+        }
+    }
+    return error;
+}
+
+static void decodeAstc(const uint8_t* block, bool isSrgb, uint8_t* texels)
+{
+    uint32_t values[8] = { 0, 0, 0, 0, 0, 0, 255, 255 };
+    uint8_t endpoints[2][4];
+    BitReader reader(block);
+
+    uint32_t blockMode = reader.read(11);
+    uint32_t partitions = reader.read(2);
+    uint32_t cem = reader.read(4);
+    if (partitions || !((blockMode == astcRgbBlockMode && cem == astcCemRgb)
+            || (blockMode == astcRgbaBlockMode && cem == astcCemRgba)))
+        throw std::runtime_error("Unsupported ASTC block configuration");
+
+    uint32_t channels = cem == astcCemRgba ? 4 : 3;
+    const uint8_t* weightTable = channels == 4 ? astcRgbaWeights : astcRgbWeights;
+    uint32_t weightBits = channels == 4 ? 2 : 3;
+    for (uint32_t i = 0; i < channels * 2; i++)
+        values[i] = reader.read(8);
+
+    if (values[1] + values[3] + values[5] >= values[0] + values[2] + values[4]) {
+        for (uint32_t c = 0; c < 4; c++) {
+            endpoints[0][c] = values[c * 2];
+            endpoints[1][c] = values[c * 2 + 1];
+        }
+    } else {
+        for (uint32_t e = 0; e < 2; e++) {
+            uint32_t b = values[5 - e];
+            endpoints[e][0] = (values[1 - e] + b) >> 1;
+            endpoints[e][1] = (values[3 - e] + b) >> 1;
+            endpoints[e][2] = b;
+            endpoints[e][3] = values[7 - e];
+        }
+    }
+
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        uint32_t index = 0;
+        for (uint32_t bit = 0; bit < weightBits; bit++) {
+            uint32_t pos = 127 - (i * weightBits + bit);
+            index |= ((block[pos >> 3] >> (pos & 7)) & 1u) << bit;
+        }
+        for (uint32_t c = 0; c < 4; c++)
+            texels[i * 4 + c] = astcInterpolate(
+                endpoints[0][c], endpoints[1][c], weightTable[index], isSrgb);
+    }
+}
+
+static bool isOpaque(const uint8_t* texels)
+{
+    for (uint32_t i = 0; i < texelsPerBlock; i++) {
+        if (texels[i * 4 + 3] != 255)
+            return false;
+    }
+    return true;
+}
+
+uint32_t getBlockBytes(BlockFormat format)
+{
+    return format == BlockFormat::BC1 ? 8 : 16;
+}
+
+uint32_t getBlockChannels(BlockFormat format)
+{
+    switch (format) {
+    case BlockFormat::BC1:
+        return 3;
+    case BlockFormat::BC5:
+        return 2;
+    default:
+        return 4;
+    }
+}
+
+const char* blockFormatToStr(BlockFormat format)
+{
+    switch (format) {
+    case BlockFormat::BC1:
+        return "BC1";
+    case BlockFormat::BC5:
+        return "BC5";
+    case BlockFormat::BC7:
+        return "BC7";
+    case BlockFormat::ASTC4x4:
+        return "ASTC 4x4";
+    default:
+        return "UNKNOWN";
+    }
+}
+
+void encodeBlock(BlockFormat format, bool isSrgb, const uint8_t* texels, uint8_t* block)
+{
+    memset(block, 0, getBlockBytes(format));
+    switch (format) {
+    case BlockFormat::BC1:
+        encodeWithRefinement(texels, 3, 8, block,
+            [texels](const float* lo, const float* hi, uint8_t* out, float* weights) {
+                return encodeBc1Endpoints(texels, lo, hi, out, weights);
+            });
+        break;
+    case BlockFormat::BC5:
+        encodeBc4(texels, 0, block);
+        encodeBc4(texels, 1, block + 8);
+        break;
+    case BlockFormat::BC7:
+        encodeWithRefinement(texels, 4, 16, block,
+            [texels](const float* lo, const float* hi, uint8_t* out, float* weights) {
+                return encodeBc7Endpoints(texels, lo, hi, out, weights);
+            });
+        break;
+    case BlockFormat::ASTC4x4: {
+        uint32_t channels = isOpaque(texels) ? 3 : 4;
+        encodeWithRefinement(texels, channels, 16, block,
+            [texels, channels, isSrgb](
+                const float* lo, const float* hi, uint8_t* out, float* weights) {
+                return encodeAstcEndpoints(texels, channels, isSrgb, lo, hi, out, weights);
+            });
+        break;
+    }
+    }
+}
+
+void decodeBlock(BlockFormat format, bool isSrgb, const uint8_t* block, uint8_t* texels)
+{
+    switch (format) {
+    case BlockFormat::BC1: {
+        uint8_t palette[4][4];
+        uint16_t c0 = block[0] | (block[1] << 8);
+        uint16_t c1 = block[2] | (block[3] << 8);
+        buildBc1Palette(c0, c1, palette);
+        for (uint32_t i = 0; i < texelsPerBlock; i++)
+            memcpy(&texels[i * 4], palette[(block[4 + i / 4] >> (2 * (i % 4))) & 3], 4);
+        break;
+    }
+    case BlockFormat::BC5:
+        decodeBc4(block, 0, texels);
+        decodeBc4(block + 8, 1, texels);
+        for (uint32_t i = 0; i < texelsPerBlock; i++) {
+            texels[i * 4 + 2] = 0;
+            texels[i * 4 + 3] = 255;
+        }
+        break;
+    case BlockFormat::BC7:
+        decodeBc7(block, texels);
+        break;
+    case BlockFormat::ASTC4x4:
+        decodeAstc(block, isSrgb, texels);
+        break;
+    }
+}
\ No newline at end of file
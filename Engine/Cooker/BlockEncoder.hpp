@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+enum class BlockFormat { BC1, BC5, BC7, ASTC4x4 };
+
+constexpr uint32_t blockDimension = 4;
+
+uint32_t getBlockBytes(BlockFormat format);
+// Number of RGBA channels the format stores, starting from R.
+uint32_t getBlockChannels(BlockFormat format);
+const char* blockFormatToStr(BlockFormat format);
+
+// Both take a 4x4 block of RGBA8 texels, row-major (64 bytes). isSrgb selects the sRGB variant of
+// the format, which only changes how ASTC interpolates; texels stay sRGB encoded either way.
+// BC7 blocks are always written in mode 6 and ASTC blocks use a single partition with 8-bit
+// endpoints, so decodeBlock only understands the subset encodeBlock produces.
+void encodeBlock(BlockFormat format, bool isSrgb, const uint8_t* texels, uint8_t* block);
+void decodeBlock(BlockFormat format, bool isSrgb, const uint8_t* block, uint8_t* texels);
\ No newline at end of file
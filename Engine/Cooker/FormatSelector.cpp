@@ -0,0 +1,59 @@
+#include "FormatSelector.hpp"
+#include <stdexcept>
+#include <vector>
+
+CookFormat getCookFormat(BlockFormat blockFormat, TextureKind kind)
+{
+    bool isSrgb = kind == TextureKind::Color;
+
+    switch (blockFormat) {
+    case BlockFormat::BC1:
+        return { blockFormat,
+            isSrgb ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK };
+    case BlockFormat::BC5:
+        if (isSrgb)
+            throw std::runtime_error(
+                "BC5 has no sRGB variant, cook color textures to BC7, ASTC or BC1 instead");
+        return { blockFormat, VK_FORMAT_BC5_UNORM_BLOCK };
+    case BlockFormat::BC7:
+        return { blockFormat, isSrgb ? VK_FORMAT_BC7_SRGB_BLOCK : VK_FORMAT_BC7_UNORM_BLOCK };
+    case BlockFormat::ASTC4x4:
+        return { blockFormat,
+            isSrgb ? VK_FORMAT_ASTC_4x4_SRGB_BLOCK : VK_FORMAT_ASTC_4x4_UNORM_BLOCK };
+    default:
+        throw std::runtime_error("Unknown block format");
+    }
+}
+
+bool isSrgbFormat(VkFormat format)
+{
+    return format == VK_FORMAT_BC1_RGB_SRGB_BLOCK || format == VK_FORMAT_BC7_SRGB_BLOCK
+        || format == VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
+}
+
+bool isFormatSampleable(VkPhysicalDevice physicalDevice, VkFormat format)
+{
+    VkFormatProperties formatProps;
+    VkFormatFeatureFlags requiredFeatures
+        = VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_TRANSFER_DST_BIT;
+
+    vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProps);
+    return (formatProps.optimalTilingFeatures & requiredFeatures) == requiredFeatures;
+}
+
+CookFormat selectCookFormat(VkPhysicalDevice physicalDevice, TextureKind kind)
+{
+    std::vector<BlockFormat> candidates;
+
+    if (kind == TextureKind::Normal)
+        candidates = { BlockFormat::BC5, BlockFormat::ASTC4x4, BlockFormat::BC7 };
+    else
+        candidates = { BlockFormat::BC7, BlockFormat::ASTC4x4, BlockFormat::BC1 };
+
+    for (BlockFormat candidate : candidates) {
+        CookFormat cookFormat = getCookFormat(candidate, kind);
+        if (isFormatSampleable(physicalDevice, cookFormat.vkFormat))
+            return cookFormat;
+    }
+    throw std::runtime_error("The selected GPU supports none of the BC or ASTC texture formats");
+}
\ No newline at end of file
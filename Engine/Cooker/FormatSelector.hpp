@@ -0,0 +1,16 @@
+#pragma once
+
+#include "BlockEncoder.hpp"
+#include "Image.hpp"
+#include <vulkan/vulkan.h>
+
+struct CookFormat {
+    BlockFormat blockFormat;
+    VkFormat vkFormat;
+};
+
+CookFormat getCookFormat(BlockFormat blockFormat, TextureKind kind);
+bool isSrgbFormat(VkFormat format);
+bool isFormatSampleable(VkPhysicalDevice physicalDevice, VkFormat format);
+// Picks the best block format for the texture kind that the device can sample from.
+CookFormat selectCookFormat(VkPhysicalDevice physicalDevice, TextureKind kind);
\ No newline at end of file
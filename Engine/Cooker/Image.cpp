@@ -0,0 +1,214 @@
+#include "Image.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+static std::string readToken(std::istream& stream)
+{
+    std::string token;
+    char c;
+
+    while (stream.get(c)) {
+        if (c == '#') {
+            stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+            continue;
+        }
+        if (!std::isspace(static_cast<unsigned char>(c))) {
+            token.push_back(c);
+            break;
+        }
+    }
+    while (stream.get(c) && !std::isspace(static_cast<unsigned char>(c)))
+        token.push_back(c);
+    return token;
+}
+
+static uint32_t parseDimension(const std::string& token, const std::string& path)
+{
+    try {
+        unsigned long value = std::stoul(token);
+        if (value && value <= 16384)
+            return static_cast<uint32_t>(value);
+    } catch (const std::exception& e) {
+    }
+    throw std::runtime_error("Invalid image header in " + path);
+}
+
+Image loadImage(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    Image image {};
+    uint32_t channels = 0;
+    std::string magic;
+
+    if (!file.is_open())
+        throw std::runtime_error("Failed to open image: " + path);
+
+    magic = readToken(file);
+    if (magic == "P6") {
+        image.width = parseDimension(readToken(file), path);
+        image.height = parseDimension(readToken(file), path);
+        if (readToken(file) != "255")
+            throw std::runtime_error("Only 8-bit images are supported: " + path);
+        channels = 3;
+    } else if (magic == "P7") {
+        std::string token;
+        while ((token = readToken(file)) != "ENDHDR") {
+            if (token.empty())
+                throw std::runtime_error("Truncated PAM header in " + path);
+            std::string value = readToken(file);
+            if (token == "WIDTH")
+                image.width = parseDimension(value, path);
+            else if (token == "HEIGHT")
+                image.height = parseDimension(value, path);
+            else if (token == "DEPTH")
+                channels = parseDimension(value, path);
+            else if (token == "MAXVAL" && value != "255")
+                throw std::runtime_error("Only 8-bit images are supported: " + path);
+        }
+        if (!image.width || !image.height || (channels != 3 && channels != 4))
+            throw std::runtime_error("Only RGB and RGB_ALPHA PAM images are supported: " + path);
+    } else {
+        throw std::runtime_error("Unsupported image format (expected PPM or PAM): " + path);
+    }
+
+    std::vector<uint8_t> raw(static_cast<size_t>(image.width) * image.height * channels);
+    if (!file.read(reinterpret_cast<char*>(raw.data()), raw.size()))
+        throw std::runtime_error("Truncated image data in " + path);
+
+    image.texels.resize(static_cast<size_t>(image.width) * image.height * 4);
+    for (size_t i = 0; i < static_cast<size_t>(image.width) * image.height; i++) {
+        for (uint32_t c = 0; c < 3; c++)
+            image.texels[i * 4 + c] = raw[i * channels + c];
+        image.texels[i * 4 + 3] = channels == 4 ? raw[i * channels + 3] : 255;
+    }
+    return image;
+}
+
+static float srgbToLinear(float value)
+{
+    return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+static float linearToSrgb(float value)
+{
+    return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+static uint8_t toUnorm8(float value)
+{
+    return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+static std::vector<float> decodeTexels(const Image& image, TextureKind kind)
+{
+    std::array<float, 256> srgbTable;
+    std::vector<float> texels(image.texels.size());
+
+    for (int i = 0; i < 256; i++)
+        srgbTable[i] = srgbToLinear(i / 255.0f);
+    for (size_t i = 0; i < texels.size(); i++) {
+        float value = image.texels[i] / 255.0f;
+        bool isColorChannel = i % 4 != 3;
+        if (kind == TextureKind::Color && isColorChannel)
+            texels[i] = srgbTable[image.texels[i]];
+        else if (kind == TextureKind::Normal && isColorChannel)
+            texels[i] = value * 2.0f - 1.0f;
+        else
+            texels[i] = value;
+    }
+    return texels;
+}
+
+static Image encodeTexels(const std::vector<float>& texels, uint32_t width, uint32_t height,
+    TextureKind kind)
+{
+    Image image { width, height, std::vector<uint8_t>(texels.size()) };
+
+    for (size_t i = 0; i < texels.size(); i++) {
+        bool isColorChannel = i % 4 != 3;
+        if (kind == TextureKind::Color && isColorChannel)
+            image.texels[i] = toUnorm8(linearToSrgb(texels[i]));
+        else if (kind == TextureKind::Normal && isColorChannel)
+            image.texels[i] = toUnorm8(texels[i] * 0.5f + 0.5f);
+        else
+            image.texels[i] = toUnorm8(texels[i]);
+    }
+    return image;
+}
+
+struct FilterTaps {
+    uint32_t count;
+    uint32_t index[3];
+    float weight[3];
+};
+
+// Box footprint of destination texel dst along one axis. Even sizes average two texels; odd sizes
+// cover 2 + 1/dstSize source texels with a 3-tap kernel so the last row/column is not dropped.
+static FilterTaps computeFilterTaps(uint32_t srcSize, uint32_t dst)
+{
+    uint32_t dstSize = std::max(srcSize / 2, 1u);
+
+    if (srcSize == 1)
+        return { 1, { 0, 0, 0 }, { 1.0f, 0.0f, 0.0f } };
+    if (srcSize % 2 == 0)
+        return { 2, { dst * 2, dst * 2 + 1, 0 }, { 0.5f, 0.5f, 0.0f } };
+
+    float norm = 1.0f / srcSize;
+    return { 3, { dst * 2, dst * 2 + 1, dst * 2 + 2 },
+        { (dstSize - dst) * norm, dstSize * norm, (dst + 1) * norm } };
+}
+
+static std::vector<float> downsample(
+    const std::vector<float>& src, uint32_t srcWidth, uint32_t srcHeight, TextureKind kind)
+{
+    uint32_t dstWidth = std::max(srcWidth / 2, 1u);
+    uint32_t dstHeight = std::max(srcHeight / 2, 1u);
+    std::vector<float> dst(static_cast<size_t>(dstWidth) * dstHeight * 4, 0.0f);
+
+    for (uint32_t y = 0; y < dstHeight; y++) {
+        FilterTaps tapsY = computeFilterTaps(srcHeight, y);
+        for (uint32_t x = 0; x < dstWidth; x++) {
+            FilterTaps tapsX = computeFilterTaps(srcWidth, x);
+            float* out = &dst[(static_cast<size_t>(y) * dstWidth + x) * 4];
+            for (uint32_t ty = 0; ty < tapsY.count; ty++) {
+                for (uint32_t tx = 0; tx < tapsX.count; tx++) {
+                    float weight = tapsY.weight[ty] * tapsX.weight[tx];
+                    const float* in = &src[(static_cast<size_t>(tapsY.index[ty]) * srcWidth
+                                               + tapsX.index[tx])
+                        * 4];
+                    for (uint32_t c = 0; c < 4; c++)
+                        out[c] += weight * in[c];
+                }
+            }
+            if (kind == TextureKind::Normal) {
+                float length = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+                if (length > 1e-6f) {
+                    for (uint32_t c = 0; c < 3; c++)
+                        out[c] /= length;
+                }
+            }
+        }
+    }
+    return dst;
+}
+
+std::vector<Image> generateMipChain(const Image& image, TextureKind kind)
+{
+    std::vector<Image> levels { image };
+    std::vector<float> texels = decodeTexels(image, kind);
+    uint32_t width = image.width;
+    uint32_t height = image.height;
+
+    while (width > 1 || height > 1) {
+        texels = downsample(texels, width, height, kind);
+        width = std::max(width / 2, 1u);
+        height = std::max(height / 2, 1u);
+        levels.push_back(encodeTexels(texels, width, height, kind));
+    }
+    return levels;
+}
\ No newline at end of file
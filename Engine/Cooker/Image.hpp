@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class TextureKind { Color, Linear, Normal };
+
+struct Image {
+    uint32_t width;
+    uint32_t height;
+    std::vector<uint8_t> texels; // RGBA8, row-major
+};
+
+// Loads binary PPM (P6) and PAM (P7, RGB or RGB_ALPHA) images as RGBA8.
+Image loadImage(const std::string& path);
+
+// Returns the full mip chain down to 1x1, level 0 being a copy of the source. Color textures are
+// filtered in linear space, normal maps are renormalized after every reduction.
+std::vector<Image> generateMipChain(const Image& image, TextureKind kind);
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "Ktx2Writer.hpp"
+#include "../Core/Ktx2.hpp"
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+// Khronos Data Format color models and transfer functions used by the basic descriptor block.
+static constexpr uint32_t dfdModelBc1 = 128;
+static constexpr uint32_t dfdModelBc5 = 132;
+static constexpr uint32_t dfdModelBc7 = 134;
+static constexpr uint32_t dfdModelAstc = 162;
+static constexpr uint32_t dfdPrimariesBt709 = 1;
+static constexpr uint32_t dfdTransferLinear = 1;
+static constexpr uint32_t dfdTransferSrgb = 2;
+
+static std::vector<uint32_t> buildDataFormatDescriptor(const CookFormat& format)
+{
+    uint32_t blockBytes = getBlockBytes(format.blockFormat);
+    uint32_t model;
+    uint32_t sampleCount = 1;
+
+    switch (format.blockFormat) {
+    case BlockFormat::BC1:
+        model = dfdModelBc1;
+        break;
+    case BlockFormat::BC5:
+        model = dfdModelBc5;
+        sampleCount = 2;
+        break;
+    case BlockFormat::BC7:
+        model = dfdModelBc7;
+        break;
+    default:
+        model = dfdModelAstc;
+        break;
+    }
+
+    uint32_t blockSize = 24 + 16 * sampleCount;
+    uint32_t transfer = isSrgbFormat(format.vkFormat) ? dfdTransferSrgb : dfdTransferLinear;
+    std::vector<uint32_t> dfd = {
+        4 + blockSize,
+        0, // vendorId = Khronos, descriptorType = basic
+        2 | (blockSize << 16),
+        model | (dfdPrimariesBt709 << 8) | (transfer << 16),
+        (blockDimension - 1) | ((blockDimension - 1) << 8),
+        blockBytes,
+        0,
+    };
+    // One sample per 64-bit channel plane; BC5 stores red and green in separate halves.
+    uint32_t sampleBits = blockBytes * 8 / sampleCount;
+    for (uint32_t i = 0; i < sampleCount; i++) {
+        dfd.push_back((i * sampleBits) | ((sampleBits - 1) << 16) | (i << 24));
+        dfd.push_back(0);
+        dfd.push_back(0);
+        dfd.push_back(UINT32_MAX);
+    }
+    return dfd;
+}
+
+void writeKtx2(const std::string& path, const CookFormat& format, uint32_t width, uint32_t height,
+    const std::vector<std::vector<uint8_t>>& levels)
+{
+    Ktx2::Header header {};
+    Ktx2::Index index {};
+    std::vector<Ktx2::LevelIndex> levelIndices(levels.size());
+    std::vector<uint32_t> dfd = buildDataFormatDescriptor(format);
+    uint64_t alignment = getBlockBytes(format.blockFormat);
+
+    header.vkFormat = format.vkFormat;
+    header.typeSize = 1;
+    header.pixelWidth = width;
+    header.pixelHeight = height;
+    header.faceCount = 1;
+    header.levelCount = static_cast<uint32_t>(levels.size());
+
+    index.dfdByteOffset
+        = static_cast<uint32_t>(Ktx2::levelIndexOffset + levels.size() * sizeof(Ktx2::LevelIndex));
+    index.dfdByteLength = static_cast<uint32_t>(dfd.size() * sizeof(uint32_t));
+
+    uint64_t offset = index.dfdByteOffset + index.dfdByteLength;
+    for (size_t level = levels.size(); level-- > 0;) {
+        offset = (offset + alignment - 1) / alignment * alignment;
+        levelIndices[level].byteOffset = offset;
+        levelIndices[level].byteLength = levels[level].size();
+        levelIndices[level].uncompressedByteLength = levels[level].size();
+        offset += levels[level].size();
+    }
+
+    std::vector<uint8_t> file(offset, 0);
+    memcpy(file.data(), Ktx2::identifier, sizeof(Ktx2::identifier));
+    memcpy(file.data() + Ktx2::headerOffset, &header, sizeof(header));
+    memcpy(file.data() + Ktx2::indexOffset, &index, sizeof(index));
+    memcpy(file.data() + Ktx2::levelIndexOffset, levelIndices.data(),
+        levelIndices.size() * sizeof(Ktx2::LevelIndex));
+    memcpy(file.data() + index.dfdByteOffset, dfd.data(), index.dfdByteLength);
+    for (size_t level = 0; level < levels.size(); level++)
+        memcpy(file.data() + levelIndices[level].byteOffset, levels[level].data(),
+            levels[level].size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+        throw std::runtime_error("Failed to open output file: " + path);
+    out.write(reinterpret_cast<const char*>(file.data()), file.size());
+    if (!out.good())
+        throw std::runtime_error("Failed to write output file: " + path);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#pragma once
+
+#include "FormatSelector.hpp"
+#include <string>
+#include <vector>
+
+// Writes a single-layer 2D KTX2 file. levels[0] is the full-resolution mip; the level data is
+// laid out smallest mip first as the KTX2 specification requires.
+void writeKtx2(const std::string& path, const CookFormat& format, uint32_t width, uint32_t height,
+    const std::vector<std::vector<uint8_t>>& levels);
\ No newline at end of file
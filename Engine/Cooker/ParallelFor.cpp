@@ -0,0 +1,40 @@
+#include "ParallelFor.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+unsigned parallelFor(size_t count, unsigned threadCount, const std::function<void(size_t)>& fn)
+{
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    std::vector<std::thread> workers;
+
+    auto work = [&]() {
+        size_t i;
+        while (!failed && (i = next++) < count) {
+            try {
+                fn(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!error)
+                    error = std::current_exception();
+                failed = true;
+            }
+        }
+    };
+
+    threadCount = static_cast<unsigned>(std::min<size_t>(std::max(threadCount, 1u), count));
+    for (unsigned i = 1; i < threadCount; i++)
+        workers.emplace_back(work);
+    work();
+    for (std::thread& worker : workers)
+        worker.join();
+    if (error)
+        std::rethrow_exception(error);
+    return threadCount;
+}
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// Runs fn(0) .. fn(count - 1) on up to threadCount threads. The first exception thrown by fn is
+// rethrown on the calling thread once every worker has stopped. Returns the number of threads that
+// actually ran, which is never more than count.
+unsigned parallelFor(size_t count, unsigned threadCount, const std::function<void(size_t)>& fn);
\ No newline at end of file
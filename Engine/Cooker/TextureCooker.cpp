@@ -0,0 +1,208 @@
+#include "TextureCooker.hpp"
+#include "../Core/Logger.hpp"
+#include "Ktx2Writer.hpp"
+#include "ParallelFor.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <set>
+#include <stdexcept>
+
+struct EncodeJob {
+    size_t image;
+    uint32_t level;
+    uint32_t blockRow;
+};
+
+struct CookStats {
+    uint64_t texelCount;
+    uint64_t blockCount;
+    double seconds;
+    unsigned threadCount;
+};
+
+static uint32_t getBlockCount(uint32_t texels)
+{
+    return (texels + blockDimension - 1) / blockDimension;
+}
+
+// Copies a 4x4 block out of the image, repeating the last row/column past the edges.
+static void fetchBlock(const Image& image, uint32_t blockX, uint32_t blockY, uint8_t* texels)
+{
+    for (uint32_t y = 0; y < blockDimension; y++) {
+        uint32_t srcY = std::min(blockY * blockDimension + y, image.height - 1);
+        for (uint32_t x = 0; x < blockDimension; x++) {
+            uint32_t srcX = std::min(blockX * blockDimension + x, image.width - 1);
+            const uint8_t* src
+                = &image.texels[(static_cast<size_t>(srcY) * image.width + srcX) * 4];
+            std::copy(src, src + 4, &texels[(y * blockDimension + x) * 4]);
+        }
+    }
+}
+
+static bool hasTransparency(const Image& image)
+{
+    for (size_t i = 3; i < image.texels.size(); i += 4) {
+        if (image.texels[i] != 255)
+            return true;
+    }
+    return false;
+}
+
+double measurePsnr(
+    const Image& image, const std::vector<uint8_t>& blocks, BlockFormat format, bool isSrgb)
+{
+    uint32_t blocksX = getBlockCount(image.width);
+    uint32_t blocksY = getBlockCount(image.height);
+    uint32_t blockBytes = getBlockBytes(format);
+    uint32_t channels = getBlockChannels(format);
+    uint8_t decoded[blockDimension * blockDimension * 4];
+    double squaredError = 0.0;
+
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            size_t blockIndex = static_cast<size_t>(blockY) * blocksX + blockX;
+            decodeBlock(format, isSrgb, &blocks[blockIndex * blockBytes], decoded);
+            for (uint32_t y = 0; y < blockDimension; y++) {
+                uint32_t srcY = blockY * blockDimension + y;
+                for (uint32_t x = 0; x < blockDimension; x++) {
+                    uint32_t srcX = blockX * blockDimension + x;
+                    if (srcX >= image.width || srcY >= image.height)
+                        continue;
+                    const uint8_t* src
+                        = &image.texels[(static_cast<size_t>(srcY) * image.width + srcX) * 4];
+                    for (uint32_t c = 0; c < channels; c++) {
+                        double delta = static_cast<double>(src[c])
+                            - decoded[(y * blockDimension + x) * 4 + c];
+                        squaredError += delta * delta;
+                    }
+                }
+            }
+        }
+    }
+
+    if (squaredError == 0.0)
+        return std::numeric_limits<double>::infinity();
+    double meanSquaredError
+        = squaredError / (static_cast<double>(image.width) * image.height * channels);
+    return 10.0 * std::log10(255.0 * 255.0 / meanSquaredError);
+}
+
+// Loads, encodes and writes inputs[first] .. inputs[first + count - 1]. Only one batch is resident
+// at a time so memory use is bounded by the batch size rather than by the number of inputs.
+static void cookBatch(const CookSettings& settings, const std::vector<std::string>& inputs,
+    const std::vector<std::filesystem::path>& outputs, size_t first, size_t count,
+    CookStats& stats)
+{
+    BlockFormat blockFormat = settings.format.blockFormat;
+    bool isSrgb = isSrgbFormat(settings.format.vkFormat);
+    uint32_t blockBytes = getBlockBytes(blockFormat);
+    std::vector<std::vector<Image>> mipChains(count);
+    std::vector<std::vector<std::vector<uint8_t>>> encodedLevels(count);
+    std::vector<EncodeJob> jobs;
+    std::array<char, 256> msgBuffer;
+
+    parallelFor(count, settings.threadCount, [&](size_t i) {
+        mipChains[i] = generateMipChain(loadImage(inputs[first + i]), settings.kind);
+    });
+    if (getBlockChannels(blockFormat) < 4) {
+        for (size_t i = 0; i < count; i++) {
+            if (hasTransparency(mipChains[i][0]))
+                LOG_WARNING(inputs[first + i] + " has transparent texels but "
+                    + blockFormatToStr(blockFormat) + " does not store alpha");
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        encodedLevels[i].resize(mipChains[i].size());
+        for (uint32_t level = 0; level < mipChains[i].size(); level++) {
+            const Image& image = mipChains[i][level];
+            uint32_t blocksX = getBlockCount(image.width);
+            uint32_t blocksY = getBlockCount(image.height);
+            encodedLevels[i][level].resize(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+            for (uint32_t blockRow = 0; blockRow < blocksY; blockRow++)
+                jobs.push_back({ i, level, blockRow });
+            stats.texelCount += static_cast<uint64_t>(image.width) * image.height;
+            stats.blockCount += static_cast<uint64_t>(blocksX) * blocksY;
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    unsigned encodeThreads = parallelFor(jobs.size(), settings.threadCount, [&](size_t j) {
+        const EncodeJob& job = jobs[j];
+        const Image& image = mipChains[job.image][job.level];
+        uint32_t blocksX = getBlockCount(image.width);
+        uint8_t* out = &encodedLevels[job.image][job.level]
+                            [static_cast<size_t>(job.blockRow) * blocksX * blockBytes];
+        uint8_t texels[blockDimension * blockDimension * 4];
+
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            fetchBlock(image, blockX, job.blockRow, texels);
+            encodeBlock(blockFormat, isSrgb, texels, out + blockX * blockBytes);
+        }
+    });
+    stats.seconds
+        += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats.threadCount = std::max(stats.threadCount, encodeThreads);
+
+    if (settings.measureQuality) {
+        std::vector<double> psnr(count);
+        parallelFor(count, settings.threadCount, [&](size_t i) {
+            psnr[i] = measurePsnr(mipChains[i][0], encodedLevels[i][0], blockFormat, isSrgb);
+        });
+        for (size_t i = 0; i < count; i++) {
+            std::snprintf(msgBuffer.data(), msgBuffer.size(), "%s: PSNR %.2f dB",
+                inputs[first + i].c_str(), psnr[i]);
+            LOG_INFO(msgBuffer.data());
+        }
+    }
+
+    parallelFor(count, settings.threadCount, [&](size_t i) {
+        writeKtx2(outputs[first + i].string(), settings.format, mipChains[i][0].width,
+            mipChains[i][0].height, encodedLevels[i]);
+    });
+}
+
+TextureCooker::TextureCooker(const CookSettings& cookSettings)
+    : settings(cookSettings)
+{
+}
+
+void TextureCooker::cook(const std::vector<std::string>& inputs, const std::string& outputDir)
+{
+    BlockFormat blockFormat = this->settings.format.blockFormat;
+    size_t batchSize = std::max(this->settings.threadCount, 1u);
+    std::vector<std::filesystem::path> outputs;
+    std::set<std::filesystem::path> uniqueOutputs;
+    CookStats stats {};
+    std::array<char, 256> msgBuffer;
+
+    for (const std::string& input : inputs) {
+        std::filesystem::path output = std::filesystem::path(outputDir)
+            / std::filesystem::path(input).stem().concat(".ktx2");
+        if (!uniqueOutputs.insert(output).second)
+            throw std::runtime_error("Multiple inputs would be cooked to " + output.string());
+        outputs.push_back(output);
+    }
+
+    std::filesystem::create_directories(outputDir);
+    for (size_t first = 0; first < inputs.size(); first += batchSize)
+        cookBatch(this->settings, inputs, outputs, first,
+            std::min(batchSize, inputs.size() - first), stats);
+
+    if (stats.seconds > 0.0)
+        std::snprintf(msgBuffer.data(), msgBuffer.size(),
+            "Encoded %llu %s blocks on %u threads in %.3f s (%.2f Mtexels/s, %.0f blocks/s)",
+            static_cast<unsigned long long>(stats.blockCount), blockFormatToStr(blockFormat),
+            stats.threadCount, stats.seconds, stats.texelCount / stats.seconds / 1e6,
+            stats.blockCount / stats.seconds);
+    else
+        std::snprintf(msgBuffer.data(), msgBuffer.size(), "Encoded %llu %s blocks on %u threads",
+            static_cast<unsigned long long>(stats.blockCount), blockFormatToStr(blockFormat),
+            stats.threadCount);
+    LOG_INFO(msgBuffer.data());
+}
\ No newline at end of file
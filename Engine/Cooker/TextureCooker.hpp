@@ -0,0 +1,28 @@
+#pragma once
+
+#include "FormatSelector.hpp"
+#include "Image.hpp"
+#include <string>
+#include <vector>
+
+struct CookSettings {
+    CookFormat format;
+    TextureKind kind;
+    unsigned threadCount;
+    bool measureQuality;
+};
+
+class TextureCooker {
+private:
+    CookSettings settings;
+
+public:
+    TextureCooker(const CookSettings& cookSettings);
+    // Cooks every input into <outputDir>/<input stem>.ktx2, threadCount images at a time. Images
+    // and the block rows of every mip level in a batch are spread across the worker threads.
+    void cook(const std::vector<std::string>& inputs, const std::string& outputDir);
+};
+
+// PSNR in dB over the channels the format stores, infinity for a lossless result.
+double measurePsnr(
+    const Image& image, const std::vector<uint8_t>& blocks, BlockFormat format, bool isSrgb);
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "../Core/GlfwContext.hpp"
+#include "../Core/Logger.hpp"
+#include "../Core/VulkanContext.hpp"
+#include "FormatSelector.hpp"
+#include "TextureCooker.hpp"
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const char* usage
+    = "Usage: texture-cooker [options] <image.ppm|image.pam>...\n"
+      "  -o <dir>                       Output directory (default: .)\n"
+      "  -t color|linear|normal         Texture kind (default: color)\n"
+      "  -f auto|bc7|bc5|bc1|astc       Block format, auto queries the engine GPU (default: auto)\n"
+      "  -j <threads>                   Worker threads (default: hardware concurrency)\n"
+      "  --psnr                         Report the PSNR of every cooked image\n";
+
+static TextureKind parseKind(const std::string& value)
+{
+    if (value == "color")
+        return TextureKind::Color;
+    if (value == "linear")
+        return TextureKind::Linear;
+    if (value == "normal")
+        return TextureKind::Normal;
+    throw std::runtime_error("Unknown texture kind: " + value);
+}
+
+static BlockFormat parseBlockFormat(const std::string& value)
+{
+    if (value == "bc7")
+        return BlockFormat::BC7;
+    if (value == "bc5")
+        return BlockFormat::BC5;
+    if (value == "bc1")
+        return BlockFormat::BC1;
+    if (value == "astc")
+        return BlockFormat::ASTC4x4;
+    throw std::runtime_error("Unknown block format: " + value);
+}
+
+static unsigned parseThreadCount(const std::string& value)
+{
+    bool isNumber = !value.empty() && value.size() <= 4
+        && std::all_of(value.begin(), value.end(), [](char c) { return c >= '0' && c <= '9'; });
+    unsigned long threadCount = isNumber ? std::stoul(value) : 0;
+
+    if (!threadCount)
+        throw std::runtime_error("Invalid thread count: " + value);
+    return static_cast<unsigned>(threadCount);
+}
+
+// Uses the same physical device the engine would render with, behind a hidden window.
+static CookFormat queryDeviceFormat(TextureKind kind)
+{
+    try {
+        GlfwContext glfwContext(false);
+        VulkanContext vkContext(glfwContext);
+
+        return selectCookFormat(vkContext.getPhysicalDevice(), kind);
+    } catch (const std::exception& e) {
+        throw std::runtime_error(std::string("Failed to query the GPU for texture formats (")
+            + e.what() + "), pass -f bc7|bc5|bc1|astc to cook without a device");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> inputs;
+    std::string outputDir = ".";
+    std::optional<BlockFormat> blockFormat;
+    CookSettings settings {};
+
+    settings.kind = TextureKind::Color;
+    settings.threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (arg == "-o" && hasValue)
+                outputDir = argv[++i];
+            else if (arg == "-t" && hasValue)
+                settings.kind = parseKind(argv[++i]);
+            else if (arg == "-f" && hasValue) {
+                std::string format = argv[++i];
+                if (format != "auto")
+                    blockFormat = parseBlockFormat(format);
+            } else if (arg == "-j" && hasValue)
+                settings.threadCount = parseThreadCount(argv[++i]);
+            else if (arg == "--psnr")
+                settings.measureQuality = true;
+            else if (arg == "-h" || arg == "--help") {
+                std::cout << usage;
+                return EXIT_SUCCESS;
+            } else if (arg[0] == '-')
+                throw std::runtime_error("Invalid argument: " + arg);
+            else
+                inputs.push_back(arg);
+        }
+        if (inputs.empty())
+            throw std::runtime_error("No input images given");
+    } catch (const std::exception& e) {
+        LOG_ERROR(e.what());
+        std::cerr << usage;
+        return EXIT_FAILURE;
+    }
+
+    try {
+        if (blockFormat)
+            settings.format = getCookFormat(*blockFormat, settings.kind);
+        else
+            settings.format = queryDeviceFormat(settings.kind);
+        LOG_INFO(std::string("Cooking to ") + blockFormatToStr(settings.format.blockFormat));
+
+        TextureCooker cooker(settings);
+        cooker.cook(inputs, outputDir);
+    } catch (const std::exception& e) {
+        LOG_ERROR(e.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include <exception>
 #include <stdexcept>
 
-GlfwContext::GlfwContext()
+GlfwContext::GlfwContext(bool visible)
     : window(nullptr)
 {
     try {
@@ -12,6 +12,7 @@ GlfwContext::GlfwContext()
             throw std::runtime_error("glfwInit failed");
         glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
         glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
         window = glfwCreateWindow(800, 800, "VulkanEngine", nullptr, nullptr);
         if (!window) {
             throw std::runtime_error("glfwCreateWindow failed");
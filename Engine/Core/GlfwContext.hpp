@@ -8,7 +8,7 @@ private:
     GLFWwindow* window;
 
 public:
-    GlfwContext();
+    GlfwContext(bool visible = true);
     ~GlfwContext();
     GLFWwindow* getWindow();
     void loop();
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+// On-disk layout of the KTX2 container shared by the texture cooker and the runtime loader.
+namespace Ktx2 {
+constexpr uint8_t identifier[12]
+    = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+
+struct Header {
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+};
+
+struct Index {
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+struct LevelIndex {
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+constexpr uint64_t headerOffset = sizeof(identifier);
+constexpr uint64_t indexOffset = headerOffset + sizeof(Header);
+constexpr uint64_t levelIndexOffset = indexOffset + sizeof(Index);
+
+static_assert(levelIndexOffset == 80, "KTX2 level index must start at byte 80");
+}
\ No newline at end of file
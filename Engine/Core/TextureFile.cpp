@@ -0,0 +1,147 @@
+#include "TextureFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Bytes per 4x4 block of the formats the texture cooker produces, 0 for anything else.
+static uint64_t getBlockBytes(VkFormat format)
+{
+    switch (format) {
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+        return 8;
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+    case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+void TextureFile::parse(const std::string& path)
+{
+    const uint8_t* bytes = static_cast<const uint8_t*>(this->mapping);
+    Ktx2::Index index;
+
+    if (this->mappingSize < Ktx2::levelIndexOffset
+        || memcmp(bytes, Ktx2::identifier, sizeof(Ktx2::identifier)))
+        throw std::runtime_error("Not a KTX2 file: " + path);
+    memcpy(&this->header, bytes + Ktx2::headerOffset, sizeof(Ktx2::Header));
+    memcpy(&index, bytes + Ktx2::indexOffset, sizeof(Ktx2::Index));
+
+    if (this->header.supercompressionScheme || this->header.pixelDepth
+        || this->header.layerCount > 1 || this->header.faceCount != 1)
+        throw std::runtime_error("Unsupported KTX2 layout (expected a plain 2D texture): " + path);
+    if (!this->header.levelCount || !this->header.pixelWidth || !this->header.pixelHeight)
+        throw std::runtime_error("KTX2 file has no mip levels: " + path);
+
+    uint64_t blockBytes = getBlockBytes(getFormat());
+    uint32_t maxLevelCount = 1;
+    if (!blockBytes)
+        throw std::runtime_error("Unsupported KTX2 texture format: " + path);
+    while (maxLevelCount < 32
+        && std::max(this->header.pixelWidth, this->header.pixelHeight) >> maxLevelCount)
+        maxLevelCount++;
+    if (this->header.levelCount > maxLevelCount)
+        throw std::runtime_error("KTX2 file has more mip levels than its size allows: " + path);
+    if (this->mappingSize
+        < Ktx2::levelIndexOffset + this->header.levelCount * sizeof(Ktx2::LevelIndex))
+        throw std::runtime_error("Truncated KTX2 level index: " + path);
+
+    this->levels.resize(this->header.levelCount);
+    memcpy(this->levels.data(), bytes + Ktx2::levelIndexOffset,
+        this->levels.size() * sizeof(Ktx2::LevelIndex));
+    for (uint32_t i = 0; i < this->header.levelCount; i++) {
+        const Ktx2::LevelIndex& level = this->levels[i];
+        uint64_t blocksX = (std::max(this->header.pixelWidth >> i, 1u) + 3) / 4;
+        uint64_t blocksY = (std::max(this->header.pixelHeight >> i, 1u) + 3) / 4;
+        if (level.byteLength != blocksX * blocksY * blockBytes)
+            throw std::runtime_error("KTX2 mip level has the wrong size: " + path);
+        if (level.byteOffset > this->mappingSize
+            || level.byteLength > this->mappingSize - level.byteOffset)
+            throw std::runtime_error("KTX2 mip level lies outside of the file: " + path);
+    }
+}
+
+TextureFile::TextureFile(const std::string& path)
+    : mapping(nullptr)
+    , mappingSize(0)
+    , header()
+    , levels()
+{
+    struct stat fileStat;
+    int fd = open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        throw std::runtime_error("Failed to open texture: " + path);
+    if (fstat(fd, &fileStat) < 0 || !fileStat.st_size) {
+        close(fd);
+        throw std::runtime_error("Failed to stat texture: " + path);
+    }
+    this->mappingSize = fileStat.st_size;
+    this->mapping = mmap(nullptr, this->mappingSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (this->mapping == MAP_FAILED) {
+        this->mapping = nullptr;
+        throw std::runtime_error("Failed to map texture: " + path);
+    }
+
+    try {
+        parse(path);
+    } catch (const std::exception& e) {
+        cleanup();
+        throw;
+    }
+}
+
+void TextureFile::cleanup()
+{
+    if (this->mapping)
+        munmap(this->mapping, this->mappingSize);
+    this->mapping = nullptr;
+}
+
+TextureFile::~TextureFile() { cleanup(); }
+
+VkFormat TextureFile::getFormat() const { return static_cast<VkFormat>(this->header.vkFormat); }
+
+uint32_t TextureFile::getWidth() const { return this->header.pixelWidth; }
+
+uint32_t TextureFile::getHeight() const { return this->header.pixelHeight; }
+
+uint32_t TextureFile::getLevelCount() const { return this->header.levelCount; }
+
+TextureLevel TextureFile::getLevel(uint32_t level) const
+{
+    const Ktx2::LevelIndex& levelIndex = this->levels.at(level);
+    TextureLevel textureLevel;
+
+    textureLevel.data = static_cast<const uint8_t*>(this->mapping) + levelIndex.byteOffset;
+    textureLevel.size = levelIndex.byteLength;
+    textureLevel.width = std::max(this->header.pixelWidth >> level, 1u);
+    textureLevel.height = std::max(this->header.pixelHeight >> level, 1u);
+    return textureLevel;
+}
+
+VkBufferImageCopy TextureFile::getCopyRegion(uint32_t level, VkDeviceSize bufferOffset) const
+{
+    TextureLevel textureLevel = getLevel(level);
+    VkBufferImageCopy region {};
+
+    region.bufferOffset = bufferOffset;
+    region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    region.imageSubresource.mipLevel = level;
+    region.imageSubresource.baseArrayLayer = 0;
+    region.imageSubresource.layerCount = 1;
+    region.imageExtent = { textureLevel.width, textureLevel.height, 1 };
+    return region;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Ktx2.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <vulkan/vulkan.h>
+
+struct TextureLevel {
+    const uint8_t* data;
+    VkDeviceSize size;
+    uint32_t width;
+    uint32_t height;
+};
+
+// Read-only, memory-mapped view of a cooked .ktx2 texture. Level data points straight into the
+// mapping so each mip can be copied into a staging buffer and uploaded on its own.
+class TextureFile {
+private:
+    void* mapping;
+    size_t mappingSize;
+    Ktx2::Header header;
+    std::vector<Ktx2::LevelIndex> levels;
+    TextureFile(TextureFile&) = delete;
+    TextureFile& operator=(TextureFile&) = delete;
+    void parse(const std::string& path);
+    void cleanup();
+
+public:
+    TextureFile(const std::string& path);
+    ~TextureFile();
+    VkFormat getFormat() const;
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    uint32_t getLevelCount() const;
+    TextureLevel getLevel(uint32_t level) const;
+    VkBufferImageCopy getCopyRegion(uint32_t level, VkDeviceSize bufferOffset) const;
+};
\ No newline at end of file
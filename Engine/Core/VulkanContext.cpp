@@ -206,6 +206,7 @@ void VulkanContext::init()
 
     createSurface();
     PhysicalDeviceInfo deviceInfo = selectPhysicalDevice();
+    this->physicalDevice = deviceInfo.device;
     this->deviceCtx.setupDevice(deviceInfo.device, deviceInfo.queueFamilyIndices);
 }
 
@@ -240,4 +241,6 @@ void VulkanContext::cleanup()
         vkDestroyInstance(this->instance, nullptr);
 }
 
-VulkanContext::~VulkanContext() { cleanup(); }
\ No newline at end of file
+VulkanContext::~VulkanContext() { cleanup(); }
+
+VkPhysicalDevice VulkanContext::getPhysicalDevice() const { return this->physicalDevice; }
\ No newline at end of file
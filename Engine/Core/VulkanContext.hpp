@@ -41,4 +41,5 @@ private:
 public:
     VulkanContext(GlfwContext& glfwCtx);
     ~VulkanContext();
+    VkPhysicalDevice getPhysicalDevice() const;
 };
\ No newline at end of file
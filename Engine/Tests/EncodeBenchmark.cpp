@@ -0,0 +1,63 @@
+#include "../Cooker/BlockEncoder.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+static constexpr uint32_t imageSize = 1024;
+static constexpr int repetitions = 3;
+
+// Smooth gradients with some per-texel noise, close to what real albedo maps give the encoders.
+static std::vector<uint8_t> makeBenchmarkImage()
+{
+    std::vector<uint8_t> texels(static_cast<size_t>(imageSize) * imageSize * 4);
+    uint32_t state = 0x2545F491;
+
+    for (uint32_t y = 0; y < imageSize; y++) {
+        for (uint32_t x = 0; x < imageSize; x++) {
+            uint8_t* texel = &texels[(static_cast<size_t>(y) * imageSize + x) * 4];
+            state = state * 1664525 + 1013904223;
+            texel[0] = (x / 4 + (state >> 29)) & 0xFF;
+            texel[1] = (y / 4 + ((state >> 26) & 7)) & 0xFF;
+            texel[2] = ((x + y) / 8 + ((state >> 23) & 7)) & 0xFF;
+            texel[3] = x < imageSize / 2 ? 255 : (x ^ y) & 0xFF;
+        }
+    }
+    return texels;
+}
+
+int main()
+{
+    std::vector<uint8_t> image = makeBenchmarkImage();
+    uint32_t blocksPerSide = imageSize / blockDimension;
+    uint8_t texels[blockDimension * blockDimension * 4];
+    uint8_t block[16];
+
+    for (BlockFormat format :
+        { BlockFormat::BC1, BlockFormat::BC5, BlockFormat::BC7, BlockFormat::ASTC4x4 }) {
+        double bestSeconds = 0.0;
+        for (int run = 0; run < repetitions; run++) {
+            auto start = std::chrono::steady_clock::now();
+            for (uint32_t blockY = 0; blockY < blocksPerSide; blockY++) {
+                for (uint32_t blockX = 0; blockX < blocksPerSide; blockX++) {
+                    for (uint32_t y = 0; y < blockDimension; y++) {
+                        size_t srcY = static_cast<size_t>(blockY) * blockDimension + y;
+                        const uint8_t* row
+                            = &image[(srcY * imageSize + blockX * blockDimension) * 4];
+                        std::copy(row, row + blockDimension * 4, &texels[y * blockDimension * 4]);
+                    }
+                    encodeBlock(format, false, texels, block);
+                }
+            }
+            double seconds
+                = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (!run || seconds < bestSeconds)
+                bestSeconds = seconds;
+        }
+        double blockCount = static_cast<double>(blocksPerSide) * blocksPerSide;
+        std::printf("%-9s %10.0f blocks/s %8.2f Mtexels/s (single thread, best of %d)\n",
+            blockFormatToStr(format), blockCount / bestSeconds,
+            blockCount * 16 / bestSeconds / 1e6, repetitions);
+    }
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,401 @@
+#include "../Cooker/BlockEncoder.hpp"
+#include "../Cooker/Image.hpp"
+#include "../Cooker/Ktx2Writer.hpp"
+#include "../Cooker/TextureCooker.hpp"
+#include "../Core/TextureFile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct ReferenceBlock {
+    BlockFormat format;
+    bool isSrgb;
+    uint8_t block[16];
+    uint8_t texels[64];
+};
+
+struct PsnrFloor {
+    BlockFormat format;
+    double gradient;
+    double noise;
+};
+
+// Blocks assembled field by field from the BC1/BC4/BC7 descriptions in the Khronos Data Format
+// specification and the ASTC block-mode table (4x4 grid, one partition, LDR direct CEM 8 and 12),
+// with texels from the specified interpolation. Endpoint pairs are chosen so every interpolated
+// value is exact and the result does not depend on decoder rounding. The last block is the ASTC RGB
+// block again, decoded as ASTC_4x4_SRGB whose endpoints expand with 0x80 rather than by repetition.
+static const ReferenceBlock referenceBlocks[] = {
+    {
+        BlockFormat::BC1,
+        false,
+        { 0x00, 0xF8, 0x1F, 0x00, 0xE4, 0xE4, 0xE4, 0xE4 },
+        {
+            255, 0, 0, 255, 0, 0, 255, 255,
+            170, 0, 85, 255, 85, 0, 170, 255,
+            255, 0, 0, 255, 0, 0, 255, 255,
+            170, 0, 85, 255, 85, 0, 170, 255,
+            255, 0, 0, 255, 0, 0, 255, 255,
+            170, 0, 85, 255, 85, 0, 170, 255,
+            255, 0, 0, 255, 0, 0, 255, 255,
+            170, 0, 85, 255, 85, 0, 170, 255 },
+    },
+    {
+        BlockFormat::BC5,
+        false,
+        { 0xAA, 0x64, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA,
+            0x32, 0xFA, 0x77, 0x39, 0x05, 0x77, 0x39, 0x05 },
+        {
+            170, 255, 0, 255, 100, 0, 0, 255,
+            160, 210, 0, 255, 150, 170, 0, 255,
+            140, 130, 0, 255, 130, 90, 0, 255,
+            120, 250, 0, 255, 110, 50, 0, 255,
+            170, 255, 0, 255, 100, 0, 0, 255,
+            160, 210, 0, 255, 150, 170, 0, 255,
+            140, 130, 0, 255, 130, 90, 0, 255,
+            120, 250, 0, 255, 110, 50, 0, 255 },
+    },
+    {
+        BlockFormat::BC7,
+        false,
+        { 0x40, 0x05, 0x99, 0xA2, 0xF5, 0x40, 0x51, 0x46,
+            0x11, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE },
+        {
+            20, 40, 60, 80, 31, 49, 66, 84,
+            45, 60, 74, 89, 57, 69, 81, 92,
+            68, 77, 87, 96, 79, 86, 93, 100,
+            94, 97, 101, 105, 105, 106, 107, 109,
+            116, 115, 114, 112, 127, 124, 120, 116,
+            142, 135, 128, 121, 153, 144, 134, 125,
+            164, 152, 140, 129, 176, 161, 147, 132,
+            190, 172, 155, 137, 201, 181, 161, 141 },
+    },
+    {
+        BlockFormat::ASTC4x4,
+        false,
+        { 0x53, 0x00, 0x29, 0xB8, 0x51, 0x90, 0x79, 0x68,
+            0x01, 0x00, 0x5F, 0x63, 0x11, 0x5F, 0x63, 0x11 },
+        {
+            20, 40, 60, 255, 48, 62, 77, 255,
+            76, 85, 94, 255, 104, 107, 111, 255,
+            136, 133, 129, 255, 164, 155, 146, 255,
+            192, 178, 163, 255, 220, 200, 180, 255,
+            20, 40, 60, 255, 48, 62, 77, 255,
+            76, 85, 94, 255, 104, 107, 111, 255,
+            136, 133, 129, 255, 164, 155, 146, 255,
+            192, 178, 163, 255, 220, 200, 180, 255 },
+    },
+    {
+        BlockFormat::ASTC4x4,
+        false,
+        { 0x42, 0x80, 0x01, 0xFE, 0x3D, 0x04, 0xB5, 0xDC,
+            0xF4, 0x15, 0x00, 0x00, 0x36, 0x36, 0x36, 0x36 },
+        {
+            0, 30, 90, 250, 255, 130, 110, 10,
+            171, 97, 103, 89, 84, 63, 96, 171,
+            0, 30, 90, 250, 255, 130, 110, 10,
+            171, 97, 103, 89, 84, 63, 96, 171,
+            0, 30, 90, 250, 255, 130, 110, 10,
+            171, 97, 103, 89, 84, 63, 96, 171,
+            0, 30, 90, 250, 255, 130, 110, 10,
+            171, 97, 103, 89, 84, 63, 96, 171 },
+    },
+    {
+        BlockFormat::ASTC4x4,
+        true,
+        { 0x53, 0x00, 0x29, 0xB8, 0x51, 0x90, 0x79, 0x68,
+            0x01, 0x00, 0x5F, 0x63, 0x11, 0x5F, 0x63, 0x11 },
+        {
+            20, 40, 60, 255, 48, 63, 77, 255,
+            76, 85, 94, 255, 104, 108, 111, 255,
+            136, 133, 129, 255, 164, 155, 146, 255,
+            192, 178, 163, 255, 220, 200, 180, 255,
+            20, 40, 60, 255, 48, 63, 77, 255,
+            76, 85, 94, 255, 104, 108, 111, 255,
+            136, 133, 129, 255, 164, 155, 146, 255,
+            192, 178, 163, 255, 220, 200, 180, 255 },
+    },
+};
+
+// A few dB under what the encoders reach today; a broken bit layout drops far below these.
+static const PsnrFloor psnrFloors[] = {
+    { BlockFormat::BC1, 38.0, 12.0 },
+    { BlockFormat::BC5, 45.0, 27.0 },
+    { BlockFormat::BC7, 44.0, 12.0 },
+    { BlockFormat::ASTC4x4, 42.0, 12.0 },
+};
+
+static Image makeGradientImage(uint32_t width, uint32_t height)
+{
+    Image image { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            uint8_t* texel = &image.texels[(static_cast<size_t>(y) * width + x) * 4];
+            texel[0] = x * 255 / (width - 1);
+            texel[1] = y * 255 / (height - 1);
+            texel[2] = static_cast<uint8_t>(128.0 + 100.0 * std::sin(x * 0.05 + y * 0.03));
+            texel[3] = (x + y) * 255 / (width + height - 2);
+        }
+    }
+    return image;
+}
+
+static Image makeNoiseImage(uint32_t width, uint32_t height)
+{
+    Image image { width, height, std::vector<uint8_t>(static_cast<size_t>(width) * height * 4) };
+    uint32_t state = 0x12345678;
+
+    for (uint8_t& value : image.texels) {
+        state = state * 1664525 + 1013904223;
+        value = state >> 24;
+    }
+    return image;
+}
+
+static std::vector<uint8_t> encodeImage(const Image& image, BlockFormat format)
+{
+    uint32_t blocksX = (image.width + blockDimension - 1) / blockDimension;
+    uint32_t blocksY = (image.height + blockDimension - 1) / blockDimension;
+    std::vector<uint8_t> blocks(static_cast<size_t>(blocksX) * blocksY * getBlockBytes(format));
+    uint8_t texels[blockDimension * blockDimension * 4];
+
+    for (uint32_t blockY = 0; blockY < blocksY; blockY++) {
+        for (uint32_t blockX = 0; blockX < blocksX; blockX++) {
+            for (uint32_t y = 0; y < blockDimension; y++) {
+                for (uint32_t x = 0; x < blockDimension; x++) {
+                    uint32_t srcX = std::min(blockX * blockDimension + x, image.width - 1);
+                    uint32_t srcY = std::min(blockY * blockDimension + y, image.height - 1);
+                    memcpy(&texels[(y * blockDimension + x) * 4],
+                        &image.texels[(static_cast<size_t>(srcY) * image.width + srcX) * 4], 4);
+                }
+            }
+            encodeBlock(format, false, texels,
+                &blocks[(static_cast<size_t>(blockY) * blocksX + blockX) * getBlockBytes(format)]);
+        }
+    }
+    return blocks;
+}
+
+static bool testReferenceBlocks()
+{
+    bool passed = true;
+
+    for (const ReferenceBlock& reference : referenceBlocks) {
+        uint32_t channels = getBlockChannels(reference.format);
+        uint8_t decoded[64];
+        uint8_t encoded[16];
+        uint8_t roundTrip[64];
+        int maxError = 0;
+
+        decodeBlock(reference.format, reference.isSrgb, reference.block, decoded);
+        for (uint32_t i = 0; i < 16; i++) {
+            for (uint32_t c = 0; c < channels; c++) {
+                if (decoded[i * 4 + c] != reference.texels[i * 4 + c]) {
+                    std::cerr << "FAIL: " << blockFormatToStr(reference.format)
+                              << " reference block texel " << i << " channel " << c << " decoded "
+                              << +decoded[i * 4 + c] << ", expected "
+                              << +reference.texels[i * 4 + c] << std::endl;
+                    passed = false;
+                }
+            }
+        }
+
+        encodeBlock(reference.format, reference.isSrgb, reference.texels, encoded);
+        decodeBlock(reference.format, reference.isSrgb, encoded, roundTrip);
+        for (uint32_t i = 0; i < 16 * 4; i++) {
+            if (i % 4 < channels)
+                maxError = std::max(maxError, std::abs(roundTrip[i] - reference.texels[i]));
+        }
+        if (maxError > 8) {
+            std::cerr << "FAIL: " << blockFormatToStr(reference.format)
+                      << " re-encoding the reference texels is off by " << maxError << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+static bool testPsnrFloors()
+{
+    Image gradient = makeGradientImage(253, 131);
+    Image noise = makeNoiseImage(64, 64);
+    bool passed = true;
+
+    for (const PsnrFloor& floor : psnrFloors) {
+        double gradientPsnr
+            = measurePsnr(gradient, encodeImage(gradient, floor.format), floor.format, false);
+        double noisePsnr
+            = measurePsnr(noise, encodeImage(noise, floor.format), floor.format, false);
+        std::cout << blockFormatToStr(floor.format) << ": gradient " << gradientPsnr
+                  << " dB, noise " << noisePsnr << " dB" << std::endl;
+        if (gradientPsnr < floor.gradient || noisePsnr < floor.noise) {
+            std::cerr << "FAIL: " << blockFormatToStr(floor.format)
+                      << " PSNR is below the floor of " << floor.gradient << " dB (gradient) / "
+                      << floor.noise << " dB (noise)" << std::endl;
+            passed = false;
+        }
+    }
+    return passed;
+}
+
+// Odd sizes must weigh every source texel: 3x3 -> 1x1 is the plain average of all nine.
+static bool testOddMipFootprint()
+{
+    Image image { 3, 3, std::vector<uint8_t>(3 * 3 * 4, 255) };
+
+    for (uint32_t i = 0; i < 9; i++)
+        image.texels[i * 4] = i == 8 ? 255 : 0;
+    std::vector<Image> levels = generateMipChain(image, TextureKind::Linear);
+    if (levels.size() != 2 || levels[1].texels[0] != 28) {
+        std::cerr << "FAIL: 3x3 -> 1x1 mip ignores part of the source footprint" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Color mips average in linear space: half black, half white is 0.5 linear, 188 in sRGB, not 128.
+static bool testGammaCorrectMip()
+{
+    Image image { 2, 2, std::vector<uint8_t>(2 * 2 * 4, 255) };
+
+    for (uint32_t i = 0; i < 2; i++)
+        std::fill_n(&image.texels[i * 4], 3, 0);
+    std::vector<Image> levels = generateMipChain(image, TextureKind::Color);
+    if (levels.size() != 2 || levels[1].texels[0] != 188 || levels[1].texels[3] != 255) {
+        std::cerr << "FAIL: 2x2 black/white color mip is " << +levels.back().texels[0]
+                  << ", expected 188" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Two orthogonal normals average to a vector of length 0.71 that must come back unit length.
+static bool testNormalMipRenormalized()
+{
+    Image image { 2, 1, { 255, 128, 128, 255, 128, 255, 128, 255 } };
+    float length = 0.0f;
+
+    std::vector<Image> levels = generateMipChain(image, TextureKind::Normal);
+    for (uint32_t c = 0; c < 3; c++) {
+        float value = levels.back().texels[c] / 255.0f * 2.0f - 1.0f;
+        length += value * value;
+    }
+    length = std::sqrt(length);
+    if (levels.size() != 2 || std::abs(length - 1.0f) > 0.01f) {
+        std::cerr << "FAIL: normal mip has length " << length << ", expected 1" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool writeAndExpectRejected(const std::string& path, const std::vector<char>& bytes,
+    const char* description)
+{
+    std::ofstream(path, std::ios::binary).write(bytes.data(), bytes.size());
+    try {
+        TextureFile file(path);
+    } catch (const std::runtime_error& e) {
+        return true;
+    }
+    std::cerr << "FAIL: TextureFile accepted a KTX2 file with " << description << std::endl;
+    return false;
+}
+
+// Writes a 37x19 BC7 mip chain, maps it back and checks every level, then corrupts the file.
+static bool testKtx2RoundTrip()
+{
+    const uint32_t width = 37;
+    const uint32_t height = 19;
+    const uint32_t levelCount = 6;
+    std::string path
+        = (std::filesystem::temp_directory_path() / "texture-cooker-test.ktx2").string();
+    CookFormat format = getCookFormat(BlockFormat::BC7, TextureKind::Color);
+    std::vector<std::vector<uint8_t>> levels(levelCount);
+    bool passed = true;
+
+    for (uint32_t level = 0; level < levelCount; level++) {
+        uint32_t blocksX = (std::max(width >> level, 1u) + blockDimension - 1) / blockDimension;
+        uint32_t blocksY = (std::max(height >> level, 1u) + blockDimension - 1) / blockDimension;
+        levels[level].resize(static_cast<size_t>(blocksX) * blocksY * 16);
+        for (size_t i = 0; i < levels[level].size(); i++)
+            levels[level][i] = static_cast<uint8_t>(level * 31 + i);
+    }
+    writeKtx2(path, format, width, height, levels);
+
+    {
+        TextureFile file(path);
+        if (file.getFormat() != VK_FORMAT_BC7_SRGB_BLOCK || file.getWidth() != width
+            || file.getHeight() != height || file.getLevelCount() != levelCount) {
+            std::cerr << "FAIL: KTX2 header does not round trip" << std::endl;
+            passed = false;
+        }
+        for (uint32_t level = 0; passed && level < levelCount; level++) {
+            TextureLevel textureLevel = file.getLevel(level);
+            VkBufferImageCopy region = file.getCopyRegion(level, 256);
+            uint32_t levelWidth = std::max(width >> level, 1u);
+            uint32_t levelHeight = std::max(height >> level, 1u);
+            if (textureLevel.width != levelWidth || textureLevel.height != levelHeight
+                || textureLevel.size != levels[level].size()
+                || memcmp(textureLevel.data, levels[level].data(), levels[level].size())) {
+                std::cerr << "FAIL: KTX2 mip level " << level << " does not round trip"
+                          << std::endl;
+                passed = false;
+            }
+            if (region.bufferOffset != 256 || region.imageSubresource.mipLevel != level
+                || region.imageExtent.width != levelWidth
+                || region.imageExtent.height != levelHeight || region.imageExtent.depth != 1) {
+                std::cerr << "FAIL: copy region of mip level " << level << " is wrong"
+                          << std::endl;
+                passed = false;
+            }
+        }
+    }
+
+    std::ifstream stream(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(stream)), {});
+    std::vector<char> truncated(bytes.begin(), bytes.end() - 1);
+    std::vector<char> wrongLength = bytes;
+    std::vector<char> tooManyLevels = bytes;
+    uint64_t byteLength = levels[1].size() + 16;
+    uint32_t badLevelCount = levelCount + 1;
+
+    memcpy(&wrongLength[Ktx2::levelIndexOffset + sizeof(Ktx2::LevelIndex)
+               + offsetof(Ktx2::LevelIndex, byteLength)],
+        &byteLength, sizeof(byteLength));
+    memcpy(&tooManyLevels[Ktx2::headerOffset + offsetof(Ktx2::Header, levelCount)],
+        &badLevelCount, sizeof(badLevelCount));
+    passed = writeAndExpectRejected(path, truncated, "a truncated last level") && passed;
+    passed = writeAndExpectRejected(path, wrongLength, "a wrong level byteLength") && passed;
+    passed = writeAndExpectRejected(path, tooManyLevels, "more levels than 37x19 has") && passed;
+    std::filesystem::remove(path);
+    return passed;
+}
+
+int main()
+{
+    bool passed;
+
+    try {
+        passed = testReferenceBlocks();
+        passed = testPsnrFloors() && passed;
+        passed = testOddMipFootprint() && passed;
+        passed = testGammaCorrectMip() && passed;
+        passed = testNormalMipRenormalized() && passed;
+        passed = testKtx2RoundTrip() && passed;
+    } catch (const std::exception& e) {
+        std::cerr << "FAIL: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file